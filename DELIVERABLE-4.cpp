@@ -5,6 +5,12 @@
 #include <iomanip>
 #include <queue>
 #include <stack>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace std;
 
@@ -20,6 +26,8 @@ struct Team {
     
     int getGoalDifference() const { return goalsScored - goalsConceded; }
     
+    void resetStats() { points = goalsScored = goalsConceded = 0; }
+    
     void display() const {
         cout << setw(15) << left << *name 
              << setw(6) << points 
@@ -105,18 +113,23 @@ public:
 
 // Match structure with pointers
 struct Match {
+    int id;
     string* date;
     Team* team1;
     Team* team2;
     int score1;
     int score2;
+    bool played;
+    bool live;      // in progress: score counts towards provisional standings
+    bool scoreFromEvents;   // goal events are complete and set the score
     
-    Match(string d, Team* t1, Team* t2, int s1, int s2)
-        : date(new string(d)), team1(t1), team2(t2), score1(s1), score2(s2) {}
+    Match(int i, string d, Team* t1, Team* t2, int s1, int s2)
+        : id(i), date(new string(d)), team1(t1), team2(t2), score1(s1), score2(s2),
+          played(false), live(false), scoreFromEvents(false) {}
     ~Match() { delete date; }
     
     void display() const {
-        cout << *date << ": " << *(team1->name) << " " << score1 << " - " 
+        cout << "#" << id << " " << *date << ": " << *(team1->name) << " " << score1 << " - " 
              << score2 << " " << *(team2->name) << endl;
     }
 };
@@ -158,6 +171,41 @@ private:
         inOrder(node->right, matches, start, end);
     }
     
+    // Recursive in-order traversal of every match, whatever its date
+    void inOrder(MatchNode* node, vector<Match*>& matches) const {
+        if (!node) return;
+        
+        inOrder(node->left, matches);
+        matches.push_back(node->match);
+        inOrder(node->right, matches);
+    }
+    
+    // Recursive removal; the match itself is not deleted
+    void remove(MatchNode* &node, Match* m) {
+        if (!node) return;
+        if (node->match != m) {
+            if (*m->date < *node->match->date) remove(node->left, m);
+            else remove(node->right, m);
+            return;
+        }
+        
+        if (node->left && node->right) {
+            // Replace with the smallest match of the right subtree
+            MatchNode** link = &node->right;
+            while ((*link)->left) link = &(*link)->left;
+            MatchNode* successor = *link;
+            *link = successor->right;
+            node->match = successor->match;
+            successor->match = nullptr;
+            delete successor;
+        } else {
+            MatchNode* child = node->left ? node->left : node->right;
+            node->match = nullptr;
+            delete node;
+            node = child;
+        }
+    }
+    
     // Recursive destructor helper
     void clear(MatchNode* node) {
         if (!node) return;
@@ -174,6 +222,23 @@ public:
         insert(root, m);
     }
     
+    // Take a match out of the tree without deleting it
+    void removeMatch(Match* m) {
+        remove(root, m);
+    }
+    
+    // Delete every match in the tree
+    void clearAll() {
+        clear(root);
+        root = nullptr;
+    }
+    
+    vector<Match*> getAllMatches() const {
+        vector<Match*> result;
+        inOrder(root, result);
+        return result;
+    }
+    
     vector<Match*> getMatchesInRange(const string& start, const string& end) const {
         vector<Match*> result;
         inOrder(root, result, start, end);
@@ -199,32 +264,284 @@ public:
         }
     }
     
+    // Forget the history without deleting the matches
+    void clear() {
+        while (!history.empty()) history.pop();
+    }
+    
+    Match* lastMatch() const {
+        return history.empty() ? nullptr : history.top();
+    }
+    
     bool isEmpty() const {
         return history.empty();
     }
 };
 
-// Queue implementation for match scheduling
+// Queue implementation for match scheduling. The queue holds match IDs in
+// play order; the fixtures themselves are kept by ID so that a result
+// arriving out of order can take its fixture out of the schedule directly.
 class MatchSchedule {
 private:
-    queue<Match*> schedule;
+    queue<int> schedule;
+    unordered_map<int, Match*> pending;
     
 public:
     void scheduleMatch(Match* m) {
-        schedule.push(m);
+        schedule.push(m->id);
+        pending[m->id] = m;
+    }
+    
+    // Next fixture in play order, left in the schedule. IDs of fixtures
+    // already taken out of order are dropped on the way.
+    Match* peekNextMatch() {
+        while (!schedule.empty() && pending.find(schedule.front()) == pending.end()) {
+            schedule.pop();
+        }
+        return schedule.empty() ? nullptr : pending[schedule.front()];
     }
     
     Match* playNextMatch() {
-        if (!schedule.empty()) {
-            Match* next = schedule.front();
+        Match* next = peekNextMatch();
+        if (next) {
             schedule.pop();
-            return next;
+            pending.erase(next->id);
         }
-        return nullptr;
+        return next;
+    }
+    
+    // Remove a pending fixture by ID (nullptr if it is not pending)
+    Match* takeMatch(int id) {
+        auto it = pending.find(id);
+        if (it == pending.end()) return nullptr;
+        Match* m = it->second;
+        pending.erase(it);
+        return m;
     }
     
     bool isEmpty() const {
-        return schedule.empty();
+        return pending.empty();
+    }
+};
+
+// Kinds of events that can happen during a match
+enum EventType { GOAL, OWN_GOAL, YELLOW_CARD, RED_CARD, SUBSTITUTION };
+
+// Columnar, append-only store for match events. Each event is one row spread
+// over parallel arrays, so a whole league history stays compact in memory.
+class MatchEventStore {
+private:
+    // Event columns (one entry per row)
+    vector<int> matchCol;
+    vector<unsigned char> minuteCol;
+    vector<unsigned char> typeCol;
+    vector<unsigned char> sideCol;      // 0 = team1, 1 = team2
+    vector<int> playerCol;
+
+    // Player names are stored once and referenced by id
+    vector<string> playerNames;
+    unordered_map<string, int> playerIds;
+
+    // Indexes: match id -> rows, player id -> rows
+    unordered_map<int, vector<int>> byMatch;
+    vector<vector<int>> byPlayer;
+
+    // Leaderboard counters, updated on every append
+    vector<int> goals;
+    vector<int> discipline;             // yellow = 1 point, red = 3 points
+
+    // Player ids kept in descending order of goals / discipline points
+    vector<int> scorerRank, scorerPos;
+    vector<int> disciplineRank, disciplinePos;
+
+    int retracted;                      // rows dropped by retractMatch
+
+    int internPlayer(const string& name) {
+        auto it = playerIds.find(name);
+        if (it != playerIds.end()) return it->second;
+
+        int id = playerNames.size();
+        playerNames.push_back(name);
+        playerIds[name] = id;
+        byPlayer.push_back(vector<int>());
+        goals.push_back(0);
+        discipline.push_back(0);
+        scorerPos.push_back(scorerRank.size());
+        scorerRank.push_back(id);
+        disciplinePos.push_back(disciplineRank.size());
+        disciplineRank.push_back(id);
+        return id;
+    }
+
+    // A counter changed by a small amount, so the player only moves past
+    // the neighbours they have overtaken or fallen behind (one step of
+    // insertion sort in either direction)
+    static void fixRank(vector<int>& rank, vector<int>& pos,
+                        const vector<int>& count, int player) {
+        int i = pos[player];
+        while (i > 0 && count[rank[i - 1]] < count[player]) {
+            rank[i] = rank[i - 1];
+            pos[rank[i]] = i;
+            i--;
+        }
+        while (i + 1 < (int)rank.size() && count[rank[i + 1]] > count[player]) {
+            rank[i] = rank[i + 1];
+            pos[rank[i]] = i;
+            i++;
+        }
+        rank[i] = player;
+        pos[player] = i;
+    }
+    
+    // Add (+1) or remove (-1) a row's contribution to the leaderboards
+    void countRow(int row, int sign) {
+        int pid = playerCol[row];
+        if (typeCol[row] == GOAL) {
+            goals[pid] += sign;
+            fixRank(scorerRank, scorerPos, goals, pid);
+        } else if (typeCol[row] == YELLOW_CARD || typeCol[row] == RED_CARD) {
+            discipline[pid] += sign * (typeCol[row] == RED_CARD ? 3 : 1);
+            fixRank(disciplineRank, disciplinePos, discipline, pid);
+        }
+    }
+
+    static vector<int> topOf(const vector<int>& rank, const vector<int>& count, int n) {
+        vector<int> result;
+        for (size_t i = 0; i < rank.size() && (int)result.size() < n; i++) {
+            if (count[rank[i]] == 0) break;
+            result.push_back(rank[i]);
+        }
+        return result;
+    }
+
+public:
+    MatchEventStore() : retracted(0) {}
+    
+    void addEvent(int matchId, int minute, EventType type, int side, const string& player) {
+        int pid = internPlayer(player);
+        int row = matchCol.size();
+
+        matchCol.push_back(matchId);
+        minuteCol.push_back(minute);
+        typeCol.push_back(type);
+        sideCol.push_back(side);
+        playerCol.push_back(pid);
+        byMatch[matchId].push_back(row);
+        byPlayer[pid].push_back(row);
+        countRow(row, 1);
+    }
+
+    // Drop a match's events from the indexes and leaderboards. The rows stay
+    // in the columns (the table is append-only) but can no longer be reached.
+    void retractMatch(int matchId) {
+        auto it = byMatch.find(matchId);
+        if (it == byMatch.end()) return;
+        for (int row : it->second) {
+            vector<int>& rows = byPlayer[playerCol[row]];
+            rows.erase(find(rows.begin(), rows.end(), row));
+            countRow(row, -1);
+        }
+        retracted += it->second.size();
+        byMatch.erase(it);
+    }
+
+    // Rebuild the columns from the rows that can still be reached, so rows
+    // dropped by retractMatch stop taking up memory
+    void compact() {
+        if (retracted == 0) return;
+        vector<int> newRow(matchCol.size(), -1);
+        for (const auto& entry : byMatch) {
+            for (int row : entry.second) newRow[row] = 0;
+        }
+        int kept = 0;
+        for (size_t row = 0; row < matchCol.size(); row++) {
+            if (newRow[row] < 0) continue;
+            newRow[row] = kept;
+            matchCol[kept] = matchCol[row];
+            minuteCol[kept] = minuteCol[row];
+            typeCol[kept] = typeCol[row];
+            sideCol[kept] = sideCol[row];
+            playerCol[kept] = playerCol[row];
+            kept++;
+        }
+        matchCol.resize(kept);
+        minuteCol.resize(kept);
+        typeCol.resize(kept);
+        sideCol.resize(kept);
+        playerCol.resize(kept);
+        matchCol.shrink_to_fit();
+        minuteCol.shrink_to_fit();
+        typeCol.shrink_to_fit();
+        sideCol.shrink_to_fit();
+        playerCol.shrink_to_fit();
+
+        for (auto& entry : byMatch) {
+            for (int& row : entry.second) row = newRow[row];
+        }
+        for (auto& rows : byPlayer) {
+            for (int& row : rows) row = newRow[row];
+        }
+        retracted = 0;
+    }
+
+    // Number of goal and own-goal events recorded for a match
+    int goalEventCount(int matchId) const {
+        auto it = byMatch.find(matchId);
+        if (it == byMatch.end()) return 0;
+        int count = 0;
+        for (int row : it->second) {
+            if (typeCol[row] == GOAL || typeCol[row] == OWN_GOAL) count++;
+        }
+        return count;
+    }
+
+    // Score implied by the goal events of a match (own goals count for the opponent)
+    void scoreFromGoals(int matchId, int& s1, int& s2) const {
+        s1 = s2 = 0;
+        auto it = byMatch.find(matchId);
+        if (it == byMatch.end()) return;
+        for (int row : it->second) {
+            int side = sideCol[row];
+            if (typeCol[row] == OWN_GOAL) side = 1 - side;
+            else if (typeCol[row] != GOAL) continue;
+            if (side == 0) s1++; else s2++;
+        }
+    }
+
+    vector<int> rowsForMatch(int matchId) const {
+        auto it = byMatch.find(matchId);
+        if (it == byMatch.end()) return vector<int>();
+        return it->second;
+    }
+
+    vector<int> rowsForPlayer(const string& player) const {
+        auto it = playerIds.find(player);
+        if (it == playerIds.end()) return vector<int>();
+        return byPlayer[it->second];
+    }
+
+    vector<int> topScorers(int n) const { return topOf(scorerRank, goals, n); }
+    vector<int> topDiscipline(int n) const { return topOf(disciplineRank, discipline, n); }
+
+    int getMatch(int row) const { return matchCol[row]; }
+    int getMinute(int row) const { return minuteCol[row]; }
+    EventType getType(int row) const { return (EventType)typeCol[row]; }
+    int getSide(int row) const { return sideCol[row]; }
+    const string& getPlayer(int row) const { return playerNames[playerCol[row]]; }
+
+    const string& playerName(int pid) const { return playerNames[pid]; }
+    int goalCount(int pid) const { return goals[pid]; }
+    int disciplinePoints(int pid) const { return discipline[pid]; }
+    int totalEvents() const { return matchCol.size() - retracted; }
+
+    static const char* typeName(EventType type) {
+        switch (type) {
+            case GOAL: return "Goal";
+            case OWN_GOAL: return "Own goal";
+            case YELLOW_CARD: return "Yellow card";
+            case RED_CARD: return "Red card";
+            default: return "Substitution";
+        }
     }
 };
 
@@ -280,6 +597,485 @@ private:
     }
 };
 
+// One team's movement in the table since the last update sent to subscribers
+struct StandingChange {
+    Team* team;
+    int oldRank;        // 0 if the team was not in the previous table
+    int newRank;
+    int oldPoints;
+    int newPoints;
+};
+
+// Interface for anyone who wants to be told when the standings change
+class StandingsSubscriber {
+public:
+    virtual ~StandingsSubscriber() {}
+    virtual void onStandingsUpdate(const vector<StandingChange>& changes) = 0;
+};
+
+// Subscriber that prints every update it receives to the console
+class ConsoleSubscriber : public StandingsSubscriber {
+private:
+    string* label;
+    
+public:
+    ConsoleSubscriber(string l) : label(new string(l)) {}
+    ~ConsoleSubscriber() { delete label; }
+    
+    void onStandingsUpdate(const vector<StandingChange>& changes) override {
+        cout << "[" << *label << "] Standings update:" << endl;
+        for (const auto& c : changes) {
+            cout << "  " << setw(15) << left << *(c.team->name);
+            if (c.oldRank == 0) cout << "new -> " << c.newRank;
+            else cout << "rank " << c.oldRank << " -> " << c.newRank;
+            cout << ", pts " << c.oldPoints << " -> " << c.newPoints << endl;
+        }
+    }
+};
+
+// Change feed for the league table. Keeps the last table sent out and sends
+// each subscriber only the teams whose rank or points have moved since then.
+class StandingsFeed {
+private:
+    vector<StandingsSubscriber*> subscribers;
+    unordered_map<Team*, pair<int, int>> lastSent;     // team -> (rank, points)
+    
+public:
+    ~StandingsFeed() {
+        for (auto s : subscribers) delete s;
+    }
+    
+    // Takes ownership of the subscriber
+    void subscribe(StandingsSubscriber* s) {
+        subscribers.push_back(s);
+    }
+    
+    bool hasSubscribers() const {
+        return !subscribers.empty();
+    }
+    
+    // Record the table as already delivered without notifying anyone
+    void rebase(const vector<Team*>& ranked) {
+        lastSent.clear();
+        for (size_t i = 0; i < ranked.size(); i++) {
+            lastSent[ranked[i]] = make_pair((int)i + 1, ranked[i]->points);
+        }
+    }
+    
+    void publish(const vector<Team*>& ranked) {
+        vector<StandingChange> changes;
+        for (size_t i = 0; i < ranked.size(); i++) {
+            Team* t = ranked[i];
+            int rank = i + 1;
+            auto it = lastSent.find(t);
+            if (it == lastSent.end()) {
+                changes.push_back({t, 0, rank, 0, t->points});
+            } else if (it->second.first != rank || it->second.second != t->points) {
+                changes.push_back({t, it->second.first, rank, it->second.second, t->points});
+            }
+        }
+        rebase(ranked);
+        
+        if (changes.empty()) return;
+        for (auto s : subscribers) {
+            s->onStandingsUpdate(changes);
+        }
+    }
+};
+
+// Packs values into a byte buffer using only as many bits as each field needs
+class BitWriter {
+private:
+    vector<unsigned char>& out;
+    int used;       // bits already used in the last byte
+    
+public:
+    BitWriter(vector<unsigned char>& o) : out(o), used(8) {}
+    
+    void write(unsigned value, int bits) {
+        for (int i = bits - 1; i >= 0; i--) {
+            if (used == 8) {
+                out.push_back(0);
+                used = 0;
+            }
+            if ((value >> i) & 1) out.back() |= 0x80 >> used;
+            used++;
+        }
+    }
+    
+    // Small numbers take one byte: 7 value bits plus a "more follows" bit
+    void writeVarint(unsigned value) {
+        while (value >= 0x80) {
+            write((value & 0x7F) | 0x80, 8);
+            value >>= 7;
+        }
+        write(value, 8);
+    }
+};
+
+// Reads back what BitWriter produced, in the same order. Reading past the
+// end of the buffer returns 0 and marks the reader as failed.
+class BitReader {
+private:
+    const vector<unsigned char>& in;
+    size_t pos;     // bit position
+    bool failed;
+    
+public:
+    BitReader(const vector<unsigned char>& i) : in(i), pos(0), failed(false) {}
+    
+    bool hasFailed() const { return failed; }
+    size_t bitsLeft() const { return in.size() * 8 - pos; }
+    
+    unsigned read(int bits) {
+        if (bits < 0 || bits > 32 || (size_t)bits > bitsLeft()) {
+            failed = true;
+            return 0;
+        }
+        unsigned value = 0;
+        for (int i = 0; i < bits; i++, pos++) {
+            int bit = (in[pos / 8] >> (7 - pos % 8)) & 1;
+            value = (value << 1) | bit;
+        }
+        return value;
+    }
+    
+    unsigned readVarint() {
+        unsigned value = 0;
+        for (int shift = 0; shift < 35 && !failed; shift += 7) {
+            unsigned byte = read(8);
+            value |= (byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        failed = true;
+        return 0;
+    }
+};
+
+// Match and standings rows as decoded from an archived season
+struct ArchivedMatch {
+    int id;
+    string date;
+    int team1;      // index into the season's team names
+    int team2;
+    int score1;
+    int score2;
+};
+
+struct ArchivedStanding {
+    int points;
+    int goalsScored;
+    int goalsConceded;
+};
+
+struct ArchivedEvent {
+    int match;      // index into the season's matches
+    int minute;
+    EventType type;
+    int side;       // 0 = team1, 1 = team2
+    int player;     // index into the season's player names
+};
+
+// Everything stored in one archived season
+struct SeasonData {
+    vector<string> teams;               // in final table order
+    vector<ArchivedMatch> matches;      // sorted by date
+    vector<ArchivedStanding> standings; // same order as teams
+    vector<string> players;
+    vector<ArchivedEvent> events;
+};
+
+// A closed season frozen into an immutable, compressed segment file.
+// Only a small header stays in memory. The segment is read from disk only
+// when a query needs it, and the bytes are released again after decoding.
+//
+// Segment layout (bit-packed, see BitWriter):
+//   teams:     count, then each name as length + bytes (in final table order)
+//   matches:   count, team id width, score width, first date,
+//              then per match: date delta, id, team1, team2, score1, score2
+//   standings: points, goals scored, goals conceded per team
+//   events:    player count and names, event count, player id width,
+//              then per event: match index, minute, type, side, player
+class ArchivedSeason {
+private:
+    string* label;
+    string* path;
+    string* firstDate;
+    string* lastDate;
+    int matchCount;
+    
+    static void writeName(BitWriter& w, const string& name) {
+        w.writeVarint(name.size());
+        for (char c : name) w.write((unsigned char)c, 8);
+    }
+    
+    static bool readName(BitReader& r, string& name) {
+        unsigned length = r.readVarint();
+        if (r.hasFailed() || length > r.bitsLeft() / 8) return false;
+        name.resize(length);
+        for (auto& c : name) c = (char)r.read(8);
+        return true;
+    }
+    
+    static int bitsNeeded(unsigned maxValue) {
+        int bits = 1;
+        while (bits < 32 && (maxValue >> bits) != 0) bits++;
+        return bits;
+    }
+    
+    // "YYYY-MM-DD" -> day number that grows with the date (31 days per month)
+    static bool encodeDate(const string& date, unsigned& out) {
+        if (date.size() != 10 || date[4] != '-' || date[7] != '-') return false;
+        for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+            if (!isdigit((unsigned char)date[i])) return false;
+        }
+        int y = stoi(date.substr(0, 4));
+        int m = stoi(date.substr(5, 2));
+        int d = stoi(date.substr(8, 2));
+        if (m < 1 || m > 12 || d < 1 || d > 31) return false;
+        out = y * 372 + (m - 1) * 31 + (d - 1);
+        return true;
+    }
+    
+    static string decodeDate(unsigned v) {
+        ostringstream os;
+        os << setfill('0') << setw(4) << v / 372 << "-"
+           << setw(2) << (v % 372) / 31 + 1 << "-"
+           << setw(2) << v % 31 + 1;
+        return os.str();
+    }
+    
+    ArchivedSeason(const string& l, const string& p, const string& first,
+                   const string& last, int count)
+        : label(new string(l)), path(new string(p)), firstDate(new string(first)),
+          lastDate(new string(last)), matchCount(count) {}
+    
+public:
+    ~ArchivedSeason() {
+        delete label;
+        delete path;
+        delete firstDate;
+        delete lastDate;
+    }
+    
+    static bool isArchivableDate(const string& date) {
+        unsigned unused;
+        return encodeDate(date, unused);
+    }
+    
+    // Write the season and its match events to a segment file. Matches must
+    // be sorted by date and teams given in final table order. Returns
+    // nullptr if the file cannot be written.
+    static ArchivedSeason* create(const string& label, const string& path,
+                                  const vector<Team*>& ranked, const vector<Match*>& ms,
+                                  const MatchEventStore& events) {
+        unordered_map<Team*, int> teamId;
+        unsigned maxScore = 0;
+        for (size_t i = 0; i < ranked.size(); i++) teamId[ranked[i]] = i;
+        for (auto m : ms) maxScore = max(maxScore, (unsigned)max(m->score1, m->score2));
+        int teamBits = bitsNeeded(ranked.size() - 1);
+        int scoreBits = bitsNeeded(maxScore);
+        
+        vector<unsigned char> bytes;
+        BitWriter w(bytes);
+        w.writeVarint(ranked.size());
+        for (auto t : ranked) writeName(w, *(t->name));
+        
+        w.writeVarint(ms.size());
+        w.write(teamBits, 5);
+        w.write(scoreBits - 1, 5);
+        unsigned prev = 0;
+        for (size_t i = 0; i < ms.size(); i++) {
+            unsigned day;
+            encodeDate(*ms[i]->date, day);
+            if (i == 0) w.writeVarint(day);
+            else w.writeVarint(day - prev);
+            prev = day;
+            w.writeVarint(ms[i]->id);
+            w.write(teamId[ms[i]->team1], teamBits);
+            w.write(teamId[ms[i]->team2], teamBits);
+            w.write(ms[i]->score1, scoreBits);
+            w.write(ms[i]->score2, scoreBits);
+        }
+        
+        for (auto t : ranked) {
+            w.writeVarint(t->points);
+            w.writeVarint(t->goalsScored);
+            w.writeVarint(t->goalsConceded);
+        }
+        
+        // Events refer to matches by their position in this segment and to
+        // players through a name table of their own
+        vector<string> players;
+        unordered_map<string, int> playerId;
+        vector<pair<int, int>> rows;        // (match index, event row)
+        for (size_t i = 0; i < ms.size(); i++) {
+            for (int row : events.rowsForMatch(ms[i]->id)) {
+                const string& name = events.getPlayer(row);
+                if (playerId.find(name) == playerId.end()) {
+                    playerId[name] = players.size();
+                    players.push_back(name);
+                }
+                rows.push_back(make_pair((int)i, row));
+            }
+        }
+        int playerBits = bitsNeeded(players.empty() ? 0 : players.size() - 1);
+        int matchBits = bitsNeeded(ms.size() - 1);
+        w.writeVarint(players.size());
+        for (const auto& name : players) writeName(w, name);
+        w.writeVarint(rows.size());
+        w.write(playerBits, 5);
+        for (const auto& entry : rows) {
+            int row = entry.second;
+            w.write(entry.first, matchBits);
+            w.write(events.getMinute(row), 8);
+            w.write(events.getType(row), 3);
+            w.write(events.getSide(row), 1);
+            w.write(playerId[events.getPlayer(row)], playerBits);
+        }
+        
+        ofstream file(path, ios::binary);
+        if (!file) return nullptr;
+        file.write((const char*)bytes.data(), bytes.size());
+        if (!file) return nullptr;
+        
+        return new ArchivedSeason(label, path, *ms.front()->date, *ms.back()->date, ms.size());
+    }
+    
+    const string& getLabel() const { return *label; }
+    const string& getFirstDate() const { return *firstDate; }
+    const string& getLastDate() const { return *lastDate; }
+    int getMatchCount() const { return matchCount; }
+    
+    bool overlaps(const string& start, const string& end) const {
+        return *firstDate <= end && *lastDate >= start;
+    }
+    
+    // Read the segment from disk and decode it. The raw bytes are freed on
+    // return; only the decoded copy handed to the caller remains.
+    // Returns false if the file is missing, truncated or corrupt.
+    bool read(SeasonData& season) const {
+        ifstream file(*path, ios::binary);
+        if (!file) return false;
+        vector<unsigned char> data((istreambuf_iterator<char>(file)),
+                                   istreambuf_iterator<char>());
+        vector<string>& names = season.teams;
+        vector<ArchivedMatch>& ms = season.matches;
+        vector<ArchivedStanding>& standings = season.standings;
+        
+        // Every count is checked against the bits left before anything is
+        // allocated, so a damaged file cannot ask for a huge buffer
+        BitReader r(data);
+        unsigned teamCount = r.readVarint();
+        if (r.hasFailed() || teamCount == 0 || teamCount > r.bitsLeft() / 8) return false;
+        names.resize(teamCount);
+        for (auto& name : names) {
+            if (!readName(r, name)) return false;
+        }
+        
+        unsigned matchCount = r.readVarint();
+        int teamBits = r.read(5);
+        int scoreBits = r.read(5) + 1;
+        if (r.hasFailed() || matchCount != (unsigned)this->matchCount || teamBits == 0
+            || matchCount > r.bitsLeft() / (16 + 2 * teamBits + 2 * scoreBits)) return false;
+        ms.resize(matchCount);
+        unsigned day = 0;
+        for (auto& m : ms) {
+            day += r.readVarint();
+            m.date = decodeDate(day);
+            m.id = r.readVarint();
+            m.team1 = r.read(teamBits);
+            m.team2 = r.read(teamBits);
+            m.score1 = r.read(scoreBits);
+            m.score2 = r.read(scoreBits);
+            if (r.hasFailed() || m.team1 >= (int)teamCount || m.team2 >= (int)teamCount
+                || m.score1 < 0 || m.score2 < 0) return false;
+        }
+        
+        standings.resize(teamCount);
+        for (auto& st : standings) {
+            st.points = r.readVarint();
+            st.goalsScored = r.readVarint();
+            st.goalsConceded = r.readVarint();
+        }
+        
+        unsigned playerCount = r.readVarint();
+        if (r.hasFailed() || playerCount > r.bitsLeft() / 8) return false;
+        season.players.resize(playerCount);
+        for (auto& name : season.players) {
+            if (!readName(r, name)) return false;
+        }
+        
+        unsigned eventCount = r.readVarint();
+        int playerBits = r.read(5);
+        int matchBits = bitsNeeded(matchCount - 1);
+        if (r.hasFailed() || playerBits == 0
+            || eventCount > r.bitsLeft() / (12 + matchBits + playerBits)) return false;
+        season.events.resize(eventCount);
+        for (auto& e : season.events) {
+            e.match = r.read(matchBits);
+            e.minute = r.read(8);
+            unsigned type = r.read(3);
+            e.side = r.read(1);
+            e.player = r.read(playerBits);
+            if (r.hasFailed() || e.match >= (int)matchCount || type > SUBSTITUTION
+                || e.player >= (int)playerCount) return false;
+            e.type = (EventType)type;
+        }
+        return !r.hasFailed();
+    }
+};
+
+// Result lines ("matchId score1 score2") read from a file or named pipe on a
+// background thread, so waiting for input overlaps with applying results
+class ResultFeed {
+private:
+    ifstream* source;
+    queue<string> lines;
+    mutex lock;
+    condition_variable ready;
+    bool finished;
+    thread reader;
+    
+    void readAll() {
+        string line;
+        while (getline(*source, line)) {
+            lock_guard<mutex> guard(lock);
+            lines.push(line);
+            ready.notify_one();
+        }
+        lock_guard<mutex> guard(lock);
+        finished = true;
+        ready.notify_one();
+    }
+    
+public:
+    ResultFeed(const string& path) : source(new ifstream(path)), finished(false) {
+        if (*source) reader = thread(&ResultFeed::readAll, this);
+    }
+    ~ResultFeed() {
+        if (reader.joinable()) reader.join();
+        delete source;
+    }
+    
+    bool isOpen() const {
+        return reader.joinable();
+    }
+    
+    // Wait until at least one line is available, then take everything queued
+    // (up to maxLines). Returns false once the feed is exhausted.
+    bool nextBatch(vector<string>& batch, size_t maxLines) {
+        batch.clear();
+        unique_lock<mutex> guard(lock);
+        ready.wait(guard, [this] { return !lines.empty() || finished; });
+        while (!lines.empty() && batch.size() < maxLines) {
+            batch.push_back(lines.front());
+            lines.pop();
+        }
+        return !batch.empty();
+    }
+};
+
 // Main score manager class
 class ScoreManager {
 private:
@@ -287,6 +1083,13 @@ private:
     MatchBST matches;
     MatchHistory history;
     MatchSchedule schedule;
+    MatchEventStore events;
+    vector<Match*> matchIndex;      // match id -> match
+    vector<Match*> liveMatches;
+    StandingsFeed feed;
+    int batchDepth;                 // > 0 while live updates are being batched
+    bool standingsDirty;
+    vector<ArchivedSeason*> archive;    // closed seasons, oldest first
     
     void updateStandings(Team* t1, Team* t2, int s1, int s2) {
         // Update goals
@@ -306,7 +1109,90 @@ private:
         }
     }
     
+    // Reverse of updateStandings, used when a result is corrected
+    void revertStandings(Team* t1, Team* t2, int s1, int s2) {
+        t1->goalsScored -= s1;
+        t1->goalsConceded -= s2;
+        t2->goalsScored -= s2;
+        t2->goalsConceded -= s1;
+        
+        if (s1 > s2) {
+            t1->points -= 3;
+        } else if (s2 > s1) {
+            t2->points -= 3;
+        } else {
+            t1->points -= 1;
+            t2->points -= 1;
+        }
+    }
+    
+    Match* newMatch(const string& date, Team* t1, Team* t2, int s1, int s2) {
+        Match* m = new Match(matchIndex.size(), date, t1, t2, s1, s2);
+        matchIndex.push_back(m);
+        return m;
+    }
+    
+    Match* findMatch(int id) const {
+        if (id < 0 || id >= (int)matchIndex.size()) return nullptr;
+        return matchIndex[id];
+    }
+    
+    // Replace a match's score and correct the standings by the difference
+    void applyScore(Match* m, int s1, int s2) {
+        revertStandings(m->team1, m->team2, m->score1, m->score2);
+        m->score1 = s1;
+        m->score2 = s2;
+        updateStandings(m->team1, m->team2, s1, s2);
+        standingsChanged();
+    }
+    
+    vector<Team*> rankedTeams() const {
+        vector<Team*> teamList = teams.getAllTeams();
+        if (teamList.size() < 2) return teamList;
+        if (teamList.size() < 10) {
+            Sorter::bubbleSortTeams(teamList);
+        } else {
+            Sorter::quickSortTeams(teamList, 0, teamList.size() - 1);
+        }
+        return teamList;
+    }
+    
+    // Send the change feed now, or once the current batch ends
+    void standingsChanged() {
+        standingsDirty = true;
+        if (batchDepth == 0) flushFeed();
+    }
+    
+    void flushFeed() {
+        if (!standingsDirty) return;
+        standingsDirty = false;
+        if (feed.hasSubscribers()) {
+            feed.publish(rankedTeams());
+        }
+    }
+    
 public:
+    ScoreManager() : batchDepth(0), standingsDirty(false) {}
+    ~ScoreManager() {
+        for (auto a : archive) delete a;
+    }
+    
+    void subscribe(StandingsSubscriber* s) {
+        if (!feed.hasSubscribers()) {
+            feed.rebase(rankedTeams());
+        }
+        feed.subscribe(s);
+    }
+    
+    // Updates made between these calls reach each subscriber as one update
+    void beginLiveBatch() {
+        batchDepth++;
+    }
+    
+    void endLiveBatch() {
+        if (batchDepth > 0 && --batchDepth == 0) flushFeed();
+    }
+
     void addTeam(const string& name) {
         if (teams.findTeam(name)) {
             cout << "Team already exists!" << endl;
@@ -325,12 +1211,18 @@ public:
             cout << "Error: One or both teams not found!" << endl;
             return;
         }
+        if (s1 < 0 || s2 < 0) {
+            cout << "Error: Scores cannot be negative!" << endl;
+            return;
+        }
         
-        Match* m = new Match(date, team1, team2, s1, s2);
+        Match* m = newMatch(date, team1, team2, s1, s2);
+        m->played = true;
         matches.addMatch(m);
         history.addMatch(m);
         updateStandings(team1, team2, s1, s2);
-        cout << "Match recorded successfully!" << endl;
+        standingsChanged();
+        cout << "Match recorded successfully! (ID " << m->id << ")" << endl;
     }
     
     void scheduleMatch(const string& date, const string& t1, const string& t2) {
@@ -343,51 +1235,334 @@ public:
         }
         
         // Score will be determined when match is played
-        Match* m = new Match(date, team1, team2, 0, 0);
+        Match* m = newMatch(date, team1, team2, 0, 0);
         schedule.scheduleMatch(m);
-        cout << "Match scheduled successfully!" << endl;
+        cout << "Match scheduled successfully! (ID " << m->id << ")" << endl;
     }
     
     void playScheduledMatch() {
-        Match* next = schedule.playNextMatch();
+        // The fixture only leaves the schedule once a valid score is entered
+        Match* next = schedule.peekNextMatch();
         if (next) {
             cout << "Playing scheduled match: " << *(next->team1->name) << " vs " 
                  << *(next->team2->name) << endl;
+            int s1, s2;
             cout << "Enter score for " << *(next->team1->name) << ": ";
-            cin >> next->score1;
+            cin >> s1;
             cout << "Enter score for " << *(next->team2->name) << ": ";
-            cin >> next->score2;
+            cin >> s2;
+            if (s1 < 0 || s2 < 0) {
+                cout << "Error: Scores cannot be negative! Match stays next in the schedule." << endl;
+                return;
+            }
             
+            schedule.playNextMatch();
+            next->score1 = s1;
+            next->score2 = s2;
+            next->played = true;
             matches.addMatch(next);
             history.addMatch(next);
             updateStandings(next->team1, next->team2, next->score1, next->score2);
+            standingsChanged();
             cout << "Match played and recorded successfully!" << endl;
         } else {
             cout << "No scheduled matches to play." << endl;
         }
     }
     
+    // Kick off the next scheduled match; it counts as 0-0 in the provisional table
+    void startNextLiveMatch() {
+        Match* next = schedule.playNextMatch();
+        if (!next) {
+            cout << "No scheduled matches to start." << endl;
+            return;
+        }
+        next->live = true;
+        liveMatches.push_back(next);
+        updateStandings(next->team1, next->team2, 0, 0);
+        standingsChanged();
+        cout << "Match #" << next->id << " is now live: " << *(next->team1->name)
+             << " vs " << *(next->team2->name) << endl;
+    }
+    
+    void updateLiveScore(int matchId, int s1, int s2) {
+        Match* m = findMatch(matchId);
+        if (!m || !m->live) {
+            cout << "Error: No live match with ID " << matchId << "!" << endl;
+            return;
+        }
+        if (m->scoreFromEvents) {
+            cout << "Error: Match #" << matchId << " takes its score from goal events!" << endl;
+            return;
+        }
+        if (s1 < 0 || s2 < 0) {
+            cout << "Error: Scores cannot be negative!" << endl;
+            return;
+        }
+        applyScore(m, s1, s2);
+        cout << "Live score: ";
+        m->display();
+    }
+    
+    // The provisional result becomes final; standings are already up to date
+    void finishLiveMatch(int matchId) {
+        Match* m = findMatch(matchId);
+        if (!m || !m->live) {
+            cout << "Error: No live match with ID " << matchId << "!" << endl;
+            return;
+        }
+        m->live = false;
+        m->played = true;
+        liveMatches.erase(find(liveMatches.begin(), liveMatches.end(), m));
+        matches.addMatch(m);
+        history.addMatch(m);
+        cout << "Full time: ";
+        m->display();
+    }
+    
+    // Apply final scores for scheduled fixtures from a results feed. Results
+    // are matched to fixtures by ID, so they may arrive in any order; repeats
+    // of an applied result are ignored. Valid results are applied a batch at
+    // a time, with one standings update per batch. Returns once the feed
+    // ends; only reading the input happens in the background.
+    void processResultFeed(const string& path, size_t batchSize = 64) {
+        ResultFeed feed(path);
+        if (!feed.isOpen()) {
+            cout << "Error: Could not open " << path << "!" << endl;
+            return;
+        }
+        
+        int batches = 0, applied = 0, duplicates = 0, conflicts = 0, rejected = 0;
+        vector<string> batch;
+        while (feed.nextBatch(batch, batchSize)) {
+            int appliedBefore = applied;
+            beginLiveBatch();
+            for (const string& line : batch) {
+                if (line.empty() || line[0] == '#') continue;
+                
+                istringstream fields(line);
+                int id, s1, s2;
+                if (!(fields >> id >> s1 >> s2) || s1 < 0 || s2 < 0) {
+                    cout << "Rejected malformed result: " << line << endl;
+                    rejected++;
+                    continue;
+                }
+                
+                Match* m = schedule.takeMatch(id);
+                if (m) {
+                    m->score1 = s1;
+                    m->score2 = s2;
+                    m->played = true;
+                    matches.addMatch(m);
+                    history.addMatch(m);
+                    updateStandings(m->team1, m->team2, s1, s2);
+                    applied++;
+                    continue;
+                }
+                
+                m = findMatch(id);
+                if (!m) {
+                    cout << "Rejected result for unknown match #" << id << endl;
+                    rejected++;
+                } else if (m->live) {
+                    cout << "Rejected result for live match #" << id << endl;
+                    rejected++;
+                } else if (m->score1 != s1 || m->score2 != s2) {
+                    cout << "Ignored conflicting result for match #" << id << " (recorded "
+                         << m->score1 << "-" << m->score2 << ", feed " << s1 << "-" << s2
+                         << ")" << endl;
+                    conflicts++;
+                } else {
+                    duplicates++;
+                }
+            }
+            if (applied > appliedBefore) standingsChanged();
+            endLiveBatch();
+            batches++;
+        }
+        
+        cout << "Results feed processed: " << applied << " applied, " << duplicates
+             << " duplicate(s), " << conflicts << " conflicting, " << rejected
+             << " rejected in " << batches << " batch(es)." << endl;
+    }
+    
+    void displayLiveMatches() {
+        cout << "\nLive Matches:\n";
+        cout << "-----------------------------------------\n";
+        for (auto m : liveMatches) {
+            m->display();
+        }
+        cout << "Total live: " << liveMatches.size() << endl;
+    }
+    
+    void recordMatchEvent(int matchId, int minute, EventType type,
+                          const string& teamName, const string& player) {
+        Match* m = findMatch(matchId);
+        if (!m || !(m->played || m->live)) {
+            cout << "Error: No played or live match with ID " << matchId << "!" << endl;
+            return;
+        }
+        
+        int side;
+        if (*(m->team1->name) == teamName) side = 0;
+        else if (*(m->team2->name) == teamName) side = 1;
+        else {
+            cout << "Error: " << teamName << " did not play in this match!" << endl;
+            return;
+        }
+        
+        if (minute < 0 || minute > 150) {
+            cout << "Error: Minute must be between 0 and 150!" << endl;
+            return;
+        }
+        
+        events.addEvent(matchId, minute, type, side, player);
+        
+        if (m->scoreFromEvents && (type == GOAL || type == OWN_GOAL)) {
+            int s1, s2;
+            events.scoreFromGoals(matchId, s1, s2);
+            applyScore(m, s1, s2);
+        }
+        cout << "Event recorded successfully!" << endl;
+    }
+    
+    // Once every goal of a match has been entered as an event, the events
+    // can take over from the entered score (and keep it up to date)
+    void useEventScore(int matchId) {
+        Match* m = findMatch(matchId);
+        if (!m || !(m->played || m->live)) {
+            cout << "Error: No played or live match with ID " << matchId << "!" << endl;
+            return;
+        }
+        if (events.goalEventCount(matchId) == 0) {
+            cout << "Error: Match #" << matchId << " has no goal events; its entered score is kept!"
+                 << endl;
+            return;
+        }
+        int s1, s2;
+        events.scoreFromGoals(matchId, s1, s2);
+        m->scoreFromEvents = true;
+        applyScore(m, s1, s2);
+        cout << "Score now taken from goal events: ";
+        m->display();
+    }
+    
+    void displayMatchTimeline(int matchId) {
+        Match* m = findMatch(matchId);
+        if (!m) {
+            if (!displayArchivedTimeline(matchId)) {
+                cout << "Error: No match with ID " << matchId << "!" << endl;
+            }
+            return;
+        }
+        
+        vector<int> rows = events.rowsForMatch(matchId);
+        stable_sort(rows.begin(), rows.end(), [this](int a, int b) {
+            return events.getMinute(a) < events.getMinute(b);
+        });
+        
+        cout << "\nMatch Timeline:\n";
+        m->display();
+        cout << "-----------------------------------------\n";
+        for (int row : rows) {
+            Team* t = events.getSide(row) == 0 ? m->team1 : m->team2;
+            cout << setw(4) << right << events.getMinute(row) << "'  " << left
+                 << setw(13) << MatchEventStore::typeName(events.getType(row))
+                 << setw(20) << events.getPlayer(row) << *(t->name) << endl;
+        }
+        cout << "Total events: " << rows.size() << endl;
+    }
+    
+    // Timeline of a match from a closed season, read from its segment
+    bool displayArchivedTimeline(int matchId) {
+        SeasonData season;
+        for (auto a : archive) {
+            if (!a->read(season)) continue;
+            for (size_t i = 0; i < season.matches.size(); i++) {
+                const ArchivedMatch& m = season.matches[i];
+                if (m.id != matchId) continue;
+                
+                vector<ArchivedEvent> timeline;
+                for (const auto& e : season.events) {
+                    if (e.match == (int)i) timeline.push_back(e);
+                }
+                stable_sort(timeline.begin(), timeline.end(),
+                            [](const ArchivedEvent& x, const ArchivedEvent& y) {
+                    return x.minute < y.minute;
+                });
+                
+                cout << "\nMatch Timeline (" << a->getLabel() << "):\n";
+                cout << "#" << m.id << " " << m.date << ": " << season.teams[m.team1] << " "
+                     << m.score1 << " - " << m.score2 << " " << season.teams[m.team2] << endl;
+                cout << "-----------------------------------------\n";
+                for (const auto& e : timeline) {
+                    const string& team = season.teams[e.side == 0 ? m.team1 : m.team2];
+                    cout << setw(4) << right << e.minute << "'  " << left
+                         << setw(13) << MatchEventStore::typeName(e.type)
+                         << setw(20) << season.players[e.player] << team << endl;
+                }
+                cout << "Total events: " << timeline.size() << endl;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void displayTopScorers(int n) {
+        vector<int> top = events.topScorers(n);
+        cout << "\nTop Scorers (current season):\n";
+        cout << "-----------------------------------------\n";
+        for (size_t i = 0; i < top.size(); i++) {
+            cout << setw(4) << left << i + 1
+                 << setw(20) << events.playerName(top[i])
+                 << events.goalCount(top[i]) << endl;
+        }
+        cout << "-----------------------------------------\n";
+    }
+    
+    void displayDisciplineTable(int n) {
+        vector<int> top = events.topDiscipline(n);
+        cout << "\nDiscipline Table, current season (yellow = 1, red = 3):\n";
+        cout << "-----------------------------------------\n";
+        cout << setw(4) << left << "#" << setw(20) << "Player"
+             << setw(5) << "YC" << setw(5) << "RC" << "Pts" << endl;
+        for (size_t i = 0; i < top.size(); i++) {
+            int yellow = 0, red = 0;
+            for (int row : events.rowsForPlayer(events.playerName(top[i]))) {
+                if (events.getType(row) == YELLOW_CARD) yellow++;
+                else if (events.getType(row) == RED_CARD) red++;
+            }
+            cout << setw(4) << i + 1
+                 << setw(20) << events.playerName(top[i])
+                 << setw(5) << yellow << setw(5) << red
+                 << events.disciplinePoints(top[i]) << endl;
+        }
+        cout << "-----------------------------------------\n";
+    }
+    
     void undoLastMatch() {
         if (history.isEmpty()) {
             cout << "No matches to undo." << endl;
             return;
         }
         cout << "Undoing last match..." << endl;
+        int id = history.lastMatch()->id;
+        matchIndex[id] = nullptr;
+        matches.removeMatch(history.lastMatch());
+        events.retractMatch(id);
         history.undoLastMatch();
         // Note: In a real implementation, we would need to reverse the standings updates
         cout << "Last match undone. Note: Standings may be inconsistent." << endl;
     }
     
     void displayStandings() {
-        vector<Team*> teamList = teams.getAllTeams();
+        vector<Team*> teamList = rankedTeams();
         
         // Using different sorting algorithms
         if (teamList.size() < 10) {
             cout << "\nUsing Bubble Sort for small dataset..." << endl;
-            Sorter::bubbleSortTeams(teamList);
         } else {
             cout << "\nUsing Quick Sort for large dataset..." << endl;
-            Sorter::quickSortTeams(teamList, 0, teamList.size() - 1);
         }
         
         cout << "\nLeague Standings:\n";
@@ -402,16 +1577,135 @@ public:
             t->display();
         }
         cout << "-------------------------------------------------\n";
+        if (!liveMatches.empty()) {
+            cout << "Provisional: " << liveMatches.size() << " match(es) in progress\n";
+        }
     }
     
     void searchMatches(const string& start, const string& end) {
         vector<Match*> results = matches.getMatchesInRange(start, end);
         cout << "\nMatches between " << start << " and " << end << ":\n";
         cout << "-----------------------------------------\n";
+        
+        // Closed seasons are only read if their dates overlap the range
+        int archived = 0;
+        SeasonData season;
+        for (auto a : archive) {
+            if (!a->overlaps(start, end)) continue;
+            if (!a->read(season)) {
+                cout << "Error: Could not read archived season " << a->getLabel() << "!" << endl;
+                continue;
+            }
+            for (const auto& m : season.matches) {
+                if (m.date < start || m.date > end) continue;
+                cout << "#" << m.id << " " << m.date << ": " << season.teams[m.team1] << " "
+                     << m.score1 << " - " << m.score2 << " " << season.teams[m.team2]
+                     << " (" << a->getLabel() << ")" << endl;
+                archived++;
+            }
+        }
         for (auto m : results) {
             m->display();
         }
-        cout << "Total matches: " << results.size() << endl;
+        cout << "Total matches: " << results.size() + archived << endl;
+    }
+    
+    // Freeze all played matches, their events and the final table into a
+    // compressed segment file, then start the new season with empty
+    // standings and leaderboards
+    void closeSeason(const string& label) {
+        if (!liveMatches.empty()) {
+            cout << "Error: Finish all live matches before closing the season!" << endl;
+            return;
+        }
+        vector<Match*> allMatches = matches.getAllMatches();
+        if (allMatches.empty()) {
+            cout << "Error: No matches played this season!" << endl;
+            return;
+        }
+        for (auto m : allMatches) {
+            if (!ArchivedSeason::isArchivableDate(*m->date)) {
+                cout << "Error: Match #" << m->id << " has an invalid date (" << *m->date
+                     << "), expected YYYY-MM-DD!" << endl;
+                return;
+            }
+            if (m->score1 < 0 || m->score2 < 0) {
+                cout << "Error: Match #" << m->id << " has a negative score!" << endl;
+                return;
+            }
+        }
+        for (auto a : archive) {
+            if (a->getLabel() == label) {
+                cout << "Error: Season " << label << " is already archived!" << endl;
+                return;
+            }
+        }
+        
+        // The archive position keeps file names unique even when two labels
+        // sanitize to the same text
+        string path = "season-" + to_string(archive.size() + 1) + "-";
+        for (char c : label) path += isalnum((unsigned char)c) ? c : '_';
+        path += ".seg";
+        
+        ArchivedSeason* season = ArchivedSeason::create(label, path, rankedTeams(),
+                                                        allMatches, events);
+        if (!season) {
+            cout << "Error: Could not write " << path << "!" << endl;
+            return;
+        }
+        archive.push_back(season);
+        
+        // The season's events now live in the segment only
+        for (auto m : allMatches) {
+            matchIndex[m->id] = nullptr;
+            events.retractMatch(m->id);
+        }
+        events.compact();
+        history.clear();
+        matches.clearAll();
+        for (auto t : teams.getAllTeams()) t->resetStats();
+        standingsChanged();
+        cout << "Season " << label << " archived to " << path << " ("
+             << allMatches.size() << " matches)." << endl;
+    }
+    
+    void displayArchivedStandings(const string& label) {
+        ArchivedSeason* season = nullptr;
+        for (auto a : archive) {
+            if (a->getLabel() == label) {
+                season = a;
+                break;
+            }
+        }
+        if (!season) {
+            cout << "Error: No archived season " << label << "!" << endl;
+            return;
+        }
+        
+        SeasonData data;
+        if (!season->read(data)) {
+            cout << "Error: Could not read archived season " << label << "!" << endl;
+            return;
+        }
+        const vector<string>& names = data.teams;
+        const vector<ArchivedStanding>& standings = data.standings;
+        
+        cout << "\nFinal Standings " << label << ":\n";
+        cout << "-------------------------------------------------\n";
+        cout << setw(15) << left << "Team" 
+             << setw(6) << "Pts" 
+             << setw(6) << "GS" 
+             << setw(6) << "GC" 
+             << setw(6) << "GD" << endl;
+        cout << "-------------------------------------------------\n";
+        for (size_t i = 0; i < names.size(); i++) {
+            cout << setw(15) << left << names[i]
+                 << setw(6) << standings[i].points
+                 << setw(6) << standings[i].goalsScored
+                 << setw(6) << standings[i].goalsConceded
+                 << setw(6) << standings[i].goalsScored - standings[i].goalsConceded << endl;
+        }
+        cout << "-------------------------------------------------\n";
     }
     
     void generateReport() {
@@ -428,11 +1722,30 @@ public:
             totalGoals += m->score1 + m->score2;
         }
         cout << "Total Goals Scored: " << totalGoals << endl;
+        cout << "Total Match Events Logged: " << events.totalEvents() << endl;
         if (!allMatches.empty()) {
             cout << "Average Goals per Match: " << fixed << setprecision(2) 
                  << (double)totalGoals / allMatches.size() << endl;
         }
         
+        if (!archive.empty()) {
+            cout << "\nArchived Seasons:\n";
+            SeasonData season;
+            for (auto a : archive) {
+                // Span and match count come from the header kept in memory
+                cout << a->getLabel() << " (" << a->getFirstDate() << " to "
+                     << a->getLastDate() << ", " << a->getMatchCount() << " matches): ";
+                if (!a->read(season)) {
+                    cout << "could not be read" << endl;
+                    continue;
+                }
+                int goals = 0;
+                for (const auto& m : season.matches) goals += m.score1 + m.score2;
+                cout << goals << " goals, " << season.events.size() << " events, champion "
+                     << season.teams[0] << endl;
+            }
+        }
+        
         // Using queue to process teams
         queue<Team*> teamQueue;
         for (auto t : teamList) {
@@ -458,15 +1771,29 @@ void displayMenu() {
     cout << "6. Search Matches by Date Range\n";
     cout << "7. Generate Statistical Report\n";
     cout << "8. Undo Last Match\n";
-    cout << "9. Exit\n";
+    cout << "9. Record Match Event\n";
+    cout << "10. View Match Timeline\n";
+    cout << "11. Top Scorers\n";
+    cout << "12. Discipline Table\n";
+    cout << "13. Start Next Scheduled Match Live\n";
+    cout << "14. Update Live Score\n";
+    cout << "15. Update Several Live Scores at Once\n";
+    cout << "16. Finish Live Match\n";
+    cout << "17. Show Live Matches\n";
+    cout << "18. Subscribe to Standings Updates\n";
+    cout << "19. Close Current Season\n";
+    cout << "20. View Archived Season Standings\n";
+    cout << "21. Process Results Feed\n";
+    cout << "22. Use Goal Events as Match Score\n";
+    cout << "23. Exit\n";
     cout << "Enter your choice: ";
 }
 
 int main() {
     ScoreManager sm;
     int choice;
-    string date, t1, t2, start, end;
-    int s1, s2;
+    string date, t1, t2, start, end, player;
+    int s1, s2, id, minute, type, count;
 
     while (true) {
         displayMenu();
@@ -529,6 +1856,106 @@ int main() {
                 break;
                 
             case 9:
+                cout << "Enter match ID: ";
+                cin >> id;
+                cout << "Enter minute: ";
+                cin >> minute;
+                cout << "Event type (0=Goal, 1=Own goal, 2=Yellow card, 3=Red card, 4=Substitution): ";
+                cin >> type;
+                cin.ignore();
+                if (type < GOAL || type > SUBSTITUTION) {
+                    cout << "Invalid event type!\n";
+                    break;
+                }
+                cout << "Enter player's team: ";
+                getline(cin, t1);
+                cout << "Enter player name: ";
+                getline(cin, player);
+                sm.recordMatchEvent(id, minute, (EventType)type, t1, player);
+                break;
+                
+            case 10:
+                cout << "Enter match ID: ";
+                cin >> id;
+                sm.displayMatchTimeline(id);
+                break;
+                
+            case 11:
+                sm.displayTopScorers(10);
+                break;
+                
+            case 12:
+                sm.displayDisciplineTable(10);
+                break;
+                
+            case 13:
+                sm.startNextLiveMatch();
+                break;
+                
+            case 14:
+                cout << "Enter match ID: ";
+                cin >> id;
+                cout << "Enter new score (team 1 team 2): ";
+                cin >> s1 >> s2;
+                sm.updateLiveScore(id, s1, s2);
+                break;
+                
+            case 15:
+                cout << "How many score updates? ";
+                cin >> count;
+                sm.beginLiveBatch();
+                for (int i = 0; i < count; i++) {
+                    cout << "Enter match ID and new score: ";
+                    cin >> id >> s1 >> s2;
+                    sm.updateLiveScore(id, s1, s2);
+                }
+                sm.endLiveBatch();
+                break;
+                
+            case 16:
+                cout << "Enter match ID: ";
+                cin >> id;
+                sm.finishLiveMatch(id);
+                break;
+                
+            case 17:
+                sm.displayLiveMatches();
+                break;
+                
+            case 18:
+                cout << "Enter subscriber name: ";
+                getline(cin, player);
+                sm.subscribe(new ConsoleSubscriber(player));
+                cout << "Subscribed successfully!" << endl;
+                break;
+                
+            case 19:
+                cout << "Enter season label (e.g. 2024-25): ";
+                getline(cin, player);
+                sm.closeSeason(player);
+                break;
+                
+            case 20:
+                cout << "Enter season label: ";
+                getline(cin, player);
+                sm.displayArchivedStandings(player);
+                break;
+                
+            case 21:
+                cout << "Results are read until the feed ends; the menu waits until then,\n"
+                     << "and a named pipe also waits here until a writer opens it.\n";
+                cout << "Enter results file or pipe (lines of: matchID score1 score2): ";
+                getline(cin, player);
+                sm.processResultFeed(player);
+                break;
+                
+            case 22:
+                cout << "Enter match ID (all its goals must already be entered as events): ";
+                cin >> id;
+                sm.useEventScore(id);
+                break;
+                
+            case 23:
                 cout << "Exiting system...\n";
                 return 0;
                 